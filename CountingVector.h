@@ -2,6 +2,7 @@
 #define COUNTINGVECTOR_H
 
 #include <vector>
+#include <cstddef>
 
 template <typename T>
 class CountingVector
@@ -19,6 +20,7 @@ public:
 
     void swap(CountingVector<T> &other);
     void push_back(const T &value);
+    void resize(int size);
 
     typename std::vector<T>::iterator begin();
     typename std::vector<T>::iterator end();
@@ -27,6 +29,7 @@ public:
     int getAccessCount() const;
     bool isAccessed(int index) const;
     void clearAccessed(int index);
+    void resetAccessCount();
 
     void enableAccessCounting();
     void disableAccessCounting();
@@ -31,6 +31,15 @@ void CountingVector<T>::push_back(const T &value)
     accessed.push_back(false);
 }
 
+// Reuses the existing allocation when shrinking or regrowing within capacity
+template <typename T>
+void CountingVector<T>::resize(int size)
+{
+    vec.resize(size);
+
+    accessed.assign(size, false);
+}
+
 template <typename T>
 typename std::vector<T>::iterator CountingVector<T>::begin()
 {
@@ -67,6 +76,12 @@ void CountingVector<T>::clearAccessed(int index)
     accessed[index] = false;
 }
 
+template <typename T>
+void CountingVector<T>::resetAccessCount()
+{
+    accessCount = 0;
+}
+
 template <typename T>
 void CountingVector<T>::enableAccessCounting()
 {
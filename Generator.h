@@ -0,0 +1,95 @@
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+
+// Resumable sequence of values produced by a coroutine with co_yield.
+// Execution only advances when the consumer asks for the next value.
+//
+// Yielding another Generator delegates to it: the root tracks the innermost
+// active generator and resumes it directly, and a finished child transfers
+// straight back to its parent, so each value costs O(1) however deep the
+// nesting is. An exception thrown at any depth ends the whole tree and is
+// rethrown from next().
+template <typename T>
+class Generator
+{
+public:
+    struct promise_type
+    {
+        T current{};
+        promise_type *root{this};
+        std::coroutine_handle<promise_type> leaf{};   // Innermost active generator, root only
+        std::coroutine_handle<promise_type> parent{};
+        std::coroutine_handle<promise_type> child{};  // Owned while delegating
+        std::exception_ptr exception{};              // Thrown anywhere in the tree, root only
+
+        promise_type() = default;
+        promise_type(const promise_type &) = delete;
+        promise_type &operator=(const promise_type &) = delete;
+        ~promise_type();
+
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept;
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() noexcept;
+        };
+
+        struct NestedAwaiter
+        {
+            std::coroutine_handle<promise_type> child;
+            std::coroutine_handle<promise_type> parent;
+
+            bool await_ready() noexcept;
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept;
+            void await_resume() noexcept;
+        };
+
+        Generator get_return_object();
+        std::suspend_always initial_suspend() noexcept;
+        FinalAwaiter final_suspend() noexcept;
+        std::suspend_always yield_value(T value);
+        NestedAwaiter yield_value(Generator &&nested);
+        void return_void();
+        void unhandled_exception();
+    };
+
+    class Iterator
+    {
+    private:
+        Generator *generator;
+
+    public:
+        explicit Iterator(Generator *generator);
+
+        const T &operator*() const;
+        Iterator &operator++();
+        bool operator==(std::default_sentinel_t) const;
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+public:
+    Generator();
+    explicit Generator(std::coroutine_handle<promise_type> handle);
+    Generator(Generator &&other) noexcept;
+    Generator &operator=(Generator &&other) noexcept;
+    Generator(const Generator &) = delete;
+    Generator &operator=(const Generator &) = delete;
+    ~Generator();
+
+    bool next();
+    const T &value() const;
+    bool done() const;
+
+    Iterator begin();
+    std::default_sentinel_t end();
+};
+
+#include "Generator.tpp"
+
+#endif // GENERATOR_H
@@ -0,0 +1,212 @@
+#include "Generator.h"
+#include <utility>
+
+template <typename T>
+Generator<T>::promise_type::~promise_type()
+{
+    // Destroyed while delegating, e.g. a sort abandoned by a restart
+    if (child)
+        child.destroy();
+}
+
+template <typename T>
+bool Generator<T>::promise_type::FinalAwaiter::await_ready() noexcept
+{
+    return false;
+}
+
+// Hands control back to the parent, or to the consumer once the root finishes
+// or something has thrown
+template <typename T>
+std::coroutine_handle<> Generator<T>::promise_type::FinalAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+{
+    promise_type &promise = handle.promise();
+
+    if (!promise.parent || promise.root->exception)
+    {
+        // Never leave the root pointing at a finished generator
+        promise.root->leaf = std::coroutine_handle<promise_type>::from_promise(*promise.root);
+
+        return std::noop_coroutine();
+    }
+
+    promise.root->leaf = promise.parent;
+
+    return promise.parent;
+}
+
+template <typename T>
+void Generator<T>::promise_type::FinalAwaiter::await_resume() noexcept {}
+
+template <typename T>
+bool Generator<T>::promise_type::NestedAwaiter::await_ready() noexcept
+{
+    return !child;
+}
+
+// Starts the child in place of the parent
+template <typename T>
+std::coroutine_handle<> Generator<T>::promise_type::NestedAwaiter::await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+{
+    parent = handle;
+
+    promise_type &parentPromise = parent.promise();
+    promise_type &childPromise = child.promise();
+
+    parentPromise.child = child;
+    childPromise.parent = parent;
+    childPromise.root = parentPromise.root;
+    childPromise.root->leaf = child;
+
+    return child;
+}
+
+// Runs in the parent after the child has finished
+template <typename T>
+void Generator<T>::promise_type::NestedAwaiter::await_resume() noexcept
+{
+    if (parent)
+    {
+        parent.promise().child = nullptr;
+        child.destroy();
+    }
+}
+
+template <typename T>
+Generator<T> Generator<T>::promise_type::get_return_object()
+{
+    leaf = std::coroutine_handle<promise_type>::from_promise(*this);
+
+    return Generator(leaf);
+}
+
+template <typename T>
+std::suspend_always Generator<T>::promise_type::initial_suspend() noexcept
+{
+    return {};
+}
+
+template <typename T>
+typename Generator<T>::promise_type::FinalAwaiter Generator<T>::promise_type::final_suspend() noexcept
+{
+    return {};
+}
+
+template <typename T>
+std::suspend_always Generator<T>::promise_type::yield_value(T value)
+{
+    current = std::move(value);
+
+    return {};
+}
+
+template <typename T>
+typename Generator<T>::promise_type::NestedAwaiter Generator<T>::promise_type::yield_value(Generator &&nested)
+{
+    return NestedAwaiter{std::exchange(nested.handle, nullptr), nullptr};
+}
+
+template <typename T>
+void Generator<T>::promise_type::return_void() {}
+
+template <typename T>
+void Generator<T>::promise_type::unhandled_exception()
+{
+    root->exception = std::current_exception();
+}
+
+template <typename T>
+Generator<T>::Iterator::Iterator(Generator *generator) : generator(generator) {}
+
+template <typename T>
+const T &Generator<T>::Iterator::operator*() const
+{
+    return generator->value();
+}
+
+template <typename T>
+typename Generator<T>::Iterator &Generator<T>::Iterator::operator++()
+{
+    generator->next();
+
+    return *this;
+}
+
+template <typename T>
+bool Generator<T>::Iterator::operator==(std::default_sentinel_t) const
+{
+    return generator->done();
+}
+
+template <typename T>
+Generator<T>::Generator() : handle(nullptr) {}
+
+template <typename T>
+Generator<T>::Generator(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+template <typename T>
+Generator<T>::Generator(Generator &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+template <typename T>
+Generator<T> &Generator<T>::operator=(Generator &&other) noexcept
+{
+    if (this != &other)
+    {
+        if (handle)
+            handle.destroy();
+
+        handle = std::exchange(other.handle, nullptr);
+    }
+
+    return *this;
+}
+
+template <typename T>
+Generator<T>::~Generator()
+{
+    if (handle)
+        handle.destroy();
+}
+
+// Resumes the innermost generator until the next value, returns false once
+// the whole tree has finished and rethrows anything thrown inside it
+template <typename T>
+bool Generator<T>::next()
+{
+    if (done())
+        return false;
+
+    promise_type &promise = handle.promise();
+    promise.leaf.resume();
+
+    if (promise.exception)
+        std::rethrow_exception(promise.exception);
+
+    return !handle.done();
+}
+
+template <typename T>
+const T &Generator<T>::value() const
+{
+    return handle.promise().leaf.promise().current;
+}
+
+template <typename T>
+bool Generator<T>::done() const
+{
+    return !handle || handle.done() || handle.promise().exception;
+}
+
+template <typename T>
+typename Generator<T>::Iterator Generator<T>::begin()
+{
+    next();
+
+    return Iterator(this);
+}
+
+template <typename T>
+std::default_sentinel_t Generator<T>::end()
+{
+    return std::default_sentinel;
+}
@@ -0,0 +1,75 @@
+#include "Hud.h"
+#include <algorithm>
+#include <charconv>
+
+Hud::Hud(const sf::Font &font, unsigned characterSize, sf::Vector2f position)
+    : fields(), font(font), characterSize(characterSize), position(position), firstMoved(0) {}
+
+int Hud::addField(const std::string &value)
+{
+    Field field{sf::Text(), value};
+    field.text.setFont(font);
+    field.text.setCharacterSize(characterSize);
+    field.text.setFillColor(sf::Color::White);
+    field.text.setString(value);
+
+    fields.push_back(field);
+    firstMoved = std::min(firstMoved, fields.size() - 1);
+
+    return fields.size() - 1;
+}
+
+void Hud::set(int field, std::string_view value)
+{
+    Field &f = fields[field];
+
+    if (f.value == value)
+        return;
+
+    f.value = value;
+    f.text.setString(f.value);
+
+    // Fields to the right move if the width changed
+    firstMoved = std::min(firstMoved, static_cast<size_t>(field + 1));
+}
+
+// Formats without allocating, so unchanged numbers cost a compare
+void Hud::set(int field, long long value)
+{
+    char buffer[24];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+
+    set(field, std::string_view(buffer, result.ptr - buffer));
+}
+
+void Hud::setColor(int field, sf::Color color)
+{
+    fields[field].text.setFillColor(color);
+}
+
+void Hud::setPosition(sf::Vector2f position)
+{
+    if (this->position != position)
+    {
+        this->position = position;
+        firstMoved = 0;
+    }
+}
+
+void Hud::draw(sf::RenderWindow &window)
+{
+    for (size_t i = firstMoved; i < fields.size(); i++)
+    {
+        const sf::Vector2f fieldPosition = i == 0
+            ? position
+            : sf::Vector2f(fields[i - 1].text.findCharacterPos(fields[i - 1].value.size()).x, position.y);
+
+        if (fields[i].text.getPosition() != fieldPosition)
+            fields[i].text.setPosition(fieldPosition);
+    }
+
+    firstMoved = fields.size();
+
+    for (const Field &field : fields)
+        window.draw(field.text);
+}
@@ -0,0 +1,38 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SFML/Graphics.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A line of text split into fields laid out left to right. Setting a field
+// to its current value is a no-op, so only changed fields are re-laid out.
+class Hud
+{
+private:
+    struct Field
+    {
+        sf::Text text;
+        std::string value;
+    };
+
+    std::vector<Field> fields;
+    const sf::Font &font;
+    unsigned characterSize;
+    sf::Vector2f position;
+    size_t firstMoved; // Fields from here on may need repositioning
+
+public:
+    Hud(const sf::Font &font, unsigned characterSize, sf::Vector2f position);
+
+    int addField(const std::string &value = "");
+    void set(int field, std::string_view value);
+    void set(int field, long long value);
+    void setColor(int field, sf::Color color);
+    void setPosition(sf::Vector2f position);
+
+    void draw(sf::RenderWindow &window);
+};
+
+#endif // HUD_H
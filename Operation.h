@@ -0,0 +1,30 @@
+#ifndef OPERATION_H
+#define OPERATION_H
+
+// A single step yielded by a sorting algorithm. Swap and Write are applied
+// to the array before they are yielded and carry enough to be undone.
+// Settle marks [first, second) as final; the runner stores the previous
+// range in oldValue and newValue when recording it. Layer starts a group of
+// operations the runner executes as a single step; the runner stores the
+// previous layer in oldValue.
+struct Operation
+{
+    enum Type
+    {
+        Compare, // first, second
+        Read,    // first
+        Swap,    // first, second
+        Write,   // first, oldValue -> newValue
+        Check,   // first, verification sweep
+        Settle,  // first, second
+        Layer    // first = layer index, second = layer count
+    };
+
+    Type type;
+    int first;
+    int second;
+    int oldValue;
+    int newValue;
+};
+
+#endif // OPERATION_H
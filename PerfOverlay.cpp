@@ -0,0 +1,124 @@
+#include "PerfOverlay.h"
+#include <algorithm>
+
+namespace
+{
+    const float GRAPH_WIDTH{480};
+    const float GRAPH_HEIGHT{80};
+    const float LEGEND_HEIGHT{22};
+    const float PADDING{8};
+    const float MS_SCALE{33.3f}; // Top of the millisecond graph, two frames at 60 fps
+    const int LEGEND_INTERVAL{15}; // Frames between legend refreshes
+
+    const std::array<sf::Color, PerfOverlay::SeriesCount> COLORS{
+        sf::Color::White,
+        sf::Color::Cyan,
+        sf::Color::Yellow,
+        sf::Color::Green,
+        sf::Color::Magenta
+    };
+
+    const std::array<const char *, PerfOverlay::SeriesCount> LABELS{
+        "frame ", "ms  draw ", "ms  sort ", "ms  ops/s ", "  voices "
+    };
+}
+
+PerfOverlay::PerfOverlay(const sf::Font &font, size_t capacity)
+    : samples(capacity, Sample{}),
+      next(0),
+      count(0),
+      legend(font, 12, sf::Vector2f(0, 0)),
+      legendFields(),
+      legendAge(0),
+      line(sf::LineStrip, capacity),
+      background(sf::Vector2f(GRAPH_WIDTH + 2 * PADDING, 2 * GRAPH_HEIGHT + LEGEND_HEIGHT + 3 * PADDING))
+{
+    background.setFillColor(sf::Color(0, 0, 0, 180));
+
+    for (int series = 0; series < SeriesCount; series++)
+    {
+        legend.addField(LABELS[series]);
+        legendFields[series] = legend.addField();
+        legend.setColor(legendFields[series], COLORS[series]);
+    }
+}
+
+void PerfOverlay::push(const Sample &sample)
+{
+    samples[next] = sample;
+    next = (next + 1) % samples.size();
+    count = std::min(count + 1, samples.size());
+}
+
+void PerfOverlay::drawSeries(sf::RenderWindow &window, Series series, sf::FloatRect area, float scale)
+{
+    if (count < 2 || scale <= 0)
+        return;
+
+    line.resize(count);
+
+    // Oldest sample on the left
+    for (size_t i = 0; i < count; i++)
+    {
+        const Sample &sample = samples[(next + samples.size() - count + i) % samples.size()];
+        const float value = std::min(sample[series] / scale, 1.0f);
+
+        line[i].position = sf::Vector2f(area.left + area.width * i / (samples.size() - 1),
+                                        area.top + area.height * (1 - value));
+        line[i].color = COLORS[series];
+    }
+
+    window.draw(line);
+}
+
+void PerfOverlay::draw(sf::RenderWindow &window, sf::Vector2f position)
+{
+    background.setPosition(position);
+    window.draw(background);
+
+    // The legend shows the latest sample, refreshed a few times a second to stay readable
+    if (count > 0 && legendAge-- <= 0)
+    {
+        const Sample &latest = samples[(next + samples.size() - 1) % samples.size()];
+
+        for (int series = 0; series < SeriesCount; series++)
+        {
+            // Millisecond series with one decimal, the rest as integers
+            if (series <= SortTime)
+            {
+                const long long tenths = static_cast<long long>(latest[series] * 10 + 0.5f);
+                legend.set(legendFields[series], std::to_string(tenths / 10) + "." + std::to_string(tenths % 10));
+            }
+            else
+            {
+                legend.set(legendFields[series], static_cast<long long>(latest[series]));
+            }
+        }
+
+        legendAge = LEGEND_INTERVAL;
+    }
+
+    legend.setPosition(sf::Vector2f(position.x + PADDING, position.y + PADDING));
+    legend.draw(window);
+
+    const sf::FloatRect timeArea(position.x + PADDING, position.y + LEGEND_HEIGHT + PADDING, GRAPH_WIDTH, GRAPH_HEIGHT);
+    const sf::FloatRect rateArea(position.x + PADDING, timeArea.top + GRAPH_HEIGHT + PADDING, GRAPH_WIDTH, GRAPH_HEIGHT);
+
+    for (Series series : {FrameTime, DrawTime, SortTime})
+        drawSeries(window, series, timeArea, MS_SCALE);
+
+    for (Series series : {OpsPerSecond, Voices})
+    {
+        float peak = 0;
+
+        for (size_t i = 0; i < count; i++)
+            peak = std::max(peak, samples[i][series]);
+
+        drawSeries(window, series, rateArea, peak);
+    }
+}
+
+sf::Vector2f PerfOverlay::getSize() const
+{
+    return background.getSize();
+}
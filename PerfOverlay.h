@@ -0,0 +1,46 @@
+#ifndef PERFOVERLAY_H
+#define PERFOVERLAY_H
+
+#include <SFML/Graphics.hpp>
+#include "Hud.h"
+#include <array>
+#include <vector>
+
+// Rolling graph of per-frame timings and throughput. Millisecond series share
+// the top graph; ops/second and audio voices are scaled to their own peaks.
+class PerfOverlay
+{
+public:
+    enum Series
+    {
+        FrameTime,    // ms
+        DrawTime,     // ms
+        SortTime,     // ms spent stepping the sort
+        OpsPerSecond,
+        Voices,       // Tones currently playing
+        SeriesCount
+    };
+
+    using Sample = std::array<float, SeriesCount>;
+
+private:
+    std::vector<Sample> samples;
+    size_t next;
+    size_t count;
+    Hud legend;
+    std::array<int, SeriesCount> legendFields;
+    int legendAge;
+    sf::VertexArray line;
+    sf::RectangleShape background;
+
+    void drawSeries(sf::RenderWindow &window, Series series, sf::FloatRect area, float scale);
+
+public:
+    PerfOverlay(const sf::Font &font, size_t capacity);
+
+    void push(const Sample &sample);
+    void draw(sf::RenderWindow &window, sf::Vector2f position);
+    sf::Vector2f getSize() const;
+};
+
+#endif // PERFOVERLAY_H
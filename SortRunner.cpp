@@ -0,0 +1,253 @@
+#include "SortRunner.h"
+#include "sorts.h"
+#include <utility>
+
+SortRunner::SortRunner(SortState &state, size_t maxHistory)
+    : state(state), sort(), verification(), history(), undone(0), maxHistory(maxHistory), checkingIndex(-1), recorded(0), held(false) {}
+
+void SortRunner::start(Generator<Operation> algorithm)
+{
+    sort = std::move(algorithm);
+    verification = Generator<Operation>();
+    history.clear();
+    undone = 0;
+    checkingIndex = -1;
+    recorded = 0;
+    held = false;
+
+    state.settledBegin = 0;
+    state.settledEnd = 0;
+    state.activeLayer = -1;
+    state.layerCount = 0;
+    state.layerOf.assign(state.numbers.size(), -1);
+}
+
+// Records an operation fresh from the algorithm, which has already applied it
+void SortRunner::record(Operation op)
+{
+    if (op.type == Operation::Compare)
+        state.comparisons++;
+
+    if (op.type == Operation::Settle)
+    {
+        op.oldValue = state.settledBegin;
+        op.newValue = state.settledEnd;
+    }
+    else if (op.type == Operation::Layer)
+    {
+        op.oldValue = state.activeLayer;
+    }
+
+    track(op);
+    recorded++;
+
+    history.push_back(op);
+
+    if (history.size() > maxHistory)
+        history.pop_front();
+}
+
+// Bookkeeping outside the array, shared by fresh and replayed operations
+void SortRunner::track(const Operation &op)
+{
+    if (op.type == Operation::Settle)
+    {
+        settle(op.first, op.second);
+    }
+    else if (op.type == Operation::Layer)
+    {
+        state.activeLayer = op.first;
+        state.layerCount = op.second;
+    }
+    else if (op.type == Operation::Compare && state.activeLayer >= 0)
+    {
+        state.layerOf[op.first] = state.activeLayer;
+        state.layerOf[op.second] = state.activeLayer;
+    }
+}
+
+void SortRunner::apply(const Operation &op)
+{
+    if (op.type == Operation::Swap)
+        std::swap(state.numbers[op.first], state.numbers[op.second]);
+    else if (op.type == Operation::Write)
+        state.numbers[op.first] = op.newValue;
+    else
+        track(op);
+}
+
+void SortRunner::undo(const Operation &op)
+{
+    if (op.type == Operation::Swap)
+        std::swap(state.numbers[op.first], state.numbers[op.second]);
+    else if (op.type == Operation::Write)
+        state.numbers[op.first] = op.oldValue;
+    else if (op.type == Operation::Settle)
+        settle(op.oldValue, op.newValue);
+    else if (op.type == Operation::Layer)
+        state.activeLayer = op.oldValue;
+}
+
+// After undoing a layer, marks the comparators of the layer before it again
+void SortRunner::restampLayer()
+{
+    if (state.activeLayer < 0)
+        return;
+
+    for (size_t i = history.size() - undone; i-- > 0 && history[i].type != Operation::Layer;)
+    {
+        if (history[i].type == Operation::Compare)
+        {
+            state.layerOf[history[i].first] = state.activeLayer;
+            state.layerOf[history[i].second] = state.activeLayer;
+        }
+    }
+}
+
+void SortRunner::settle(int begin, int end)
+{
+    state.settledBegin = begin;
+    state.settledEnd = end;
+}
+
+// Pulls the algorithm's next operation without recording it, false once it has finished
+bool SortRunner::peek()
+{
+    if (!held)
+        held = sort.next();
+
+    return held;
+}
+
+// Advances by a single operation, returns false once sorting and verification are done
+bool SortRunner::advance()
+{
+    // Replay rewound operations before resuming the algorithm
+    if (undone > 0)
+    {
+        apply(history[history.size() - undone]);
+        undone--;
+        return true;
+    }
+
+    if (!state.sortingComplete)
+    {
+        if (peek())
+        {
+            held = false;
+            record(sort.value());
+            return true;
+        }
+
+        // Full sorts don't report progress, everything is final once they finish
+        if (state.settledBegin == state.settledEnd)
+            settle(0, state.numbers.size());
+
+        state.activeLayer = -1;
+        state.sortingComplete = true;
+        verification = verify(state);
+    }
+
+    state.numbers.disableAccessCounting();
+    const bool checking = verification.next();
+    state.numbers.enableAccessCounting();
+
+    if (checking)
+        checkingIndex = verification.value().first;
+
+    return checking;
+}
+
+// Whether the next operation starts a new layer or there is nothing left in this one
+bool SortRunner::atLayerBoundary()
+{
+    if (undone > 0)
+        return history[history.size() - undone].type == Operation::Layer;
+
+    return state.sortingComplete || !peek() || sort.value().type == Operation::Layer;
+}
+
+// Advances by one step, a whole layer while inside one, returns the number of operations recorded
+int SortRunner::step()
+{
+    const int before = recorded;
+
+    state.numbers.enableAccessCounting();
+
+    if (advance())
+    {
+        while (state.activeLayer >= 0 && !atLayerBoundary())
+            advance();
+    }
+
+    state.numbers.disableAccessCounting();
+
+    return recorded - before;
+}
+
+// Undoes the most recent step, only possible until sorting completes
+bool SortRunner::stepBack()
+{
+    if (state.sortingComplete || undone == history.size())
+        return false;
+
+    state.numbers.enableAccessCounting();
+
+    const bool inLayer = state.activeLayer >= 0;
+
+    while (undone < history.size())
+    {
+        undone++;
+
+        const Operation &op = history[history.size() - undone];
+        undo(op);
+
+        if (op.type == Operation::Layer)
+        {
+            restampLayer();
+            break;
+        }
+
+        if (!inLayer)
+            break;
+    }
+
+    state.numbers.disableAccessCounting();
+
+    return true;
+}
+
+// Advances until maxOperations operations have run or the time budget is spent,
+// stopping mid-layer if need be so large networks still yield the frame.
+// Returns the number of operations recorded, replays and verification excluded
+int SortRunner::run(int maxOperations, std::chrono::microseconds budget)
+{
+    const auto start = std::chrono::steady_clock::now();
+    const int before = recorded;
+    int operations = 0;
+
+    state.numbers.enableAccessCounting();
+
+    while (operations < maxOperations && advance())
+    {
+        operations++;
+
+        // Checking the clock is comparatively expensive, so only do it periodically
+        if (operations % 64 == 0 && std::chrono::steady_clock::now() - start >= budget)
+            break;
+    }
+
+    state.numbers.disableAccessCounting();
+
+    return recorded - before;
+}
+
+bool SortRunner::isFinished() const
+{
+    return state.sortingComplete && verification.done();
+}
+
+int SortRunner::getCheckingIndex() const
+{
+    return checkingIndex;
+}
@@ -0,0 +1,50 @@
+#ifndef SORTRUNNER_H
+#define SORTRUNNER_H
+
+#include "SortState.h"
+#include "Operation.h"
+#include "Generator.h"
+#include <chrono>
+#include <deque>
+
+// Drives a sorting algorithm one operation at a time on the caller's thread,
+// followed by a verification sweep. When stepping manually, a Layer operation
+// and everything up to the next one count as a single step. Keeps a bounded
+// history so the sort can be stepped backwards and replayed.
+class SortRunner
+{
+private:
+    SortState &state;
+    Generator<Operation> sort;
+    Generator<Operation> verification;
+    std::deque<Operation> history;
+    size_t undone{0};
+    size_t maxHistory;
+    int checkingIndex{-1};
+    int recorded{0}; // Operations recorded fresh from the algorithm so far
+    bool held{false}; // The generator's current value has not been recorded yet
+
+    void record(Operation op);
+    void track(const Operation &op);
+    void apply(const Operation &op);
+    void undo(const Operation &op);
+    void settle(int begin, int end);
+    void restampLayer();
+    bool peek();
+    bool advance();
+    bool atLayerBoundary();
+
+public:
+    SortRunner(SortState &state, size_t maxHistory);
+
+    void start(Generator<Operation> algorithm);
+
+    int step();
+    bool stepBack();
+    int run(int maxOperations, std::chrono::microseconds budget);
+
+    bool isFinished() const;
+    int getCheckingIndex() const;
+};
+
+#endif // SORTRUNNER_H
@@ -2,15 +2,26 @@
 #define SORTSTATE_H
 
 #include "CountingVector.h"
-#include <mutex>
+#include <vector>
 
 struct SortState
 {
     CountingVector<int> numbers;
-    std::mutex mtx;
     int comparisons;
     bool sortingComplete;
-    bool running;
+
+    // Rank for selection algorithms, ignored by full sorts
+    int k;
+
+    // Elements in [settledBegin, settledEnd) are in their final position
+    int settledBegin;
+    int settledEnd;
+
+    // Sorting networks: the layer being executed, -1 for none, and the
+    // last layer whose comparators touched each index
+    int activeLayer;
+    int layerCount;
+    std::vector<int> layerOf;
 };
 
 #endif // SORTSTATE_H
@@ -0,0 +1,226 @@
+#include "benchmark.h"
+#include "networks.h"
+#include "selection.h"
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <set>
+#include <vector>
+
+namespace
+{
+    // Quadratic algorithms are skipped above this size, bogo always is
+    const int QUADRATIC_LIMIT{20000};
+    const std::set<std::string> QUADRATIC{"bubble", "selection", "insertion"};
+
+    template <typename F>
+    double timeMs(F &&f)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        f();
+
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    const char *status(bool sorted)
+    {
+        return sorted ? "" : "  FAILED";
+    }
+
+    // The k smallest are sorted at the front, or the k-th smallest is at
+    // k - 1 with smaller elements before it when only that was settled
+    bool settled(SortState &state, const std::vector<int> &sorted)
+    {
+        if (state.settledBegin == state.settledEnd)
+            return std::is_sorted(state.numbers.begin(), state.numbers.end());
+
+        for (int i = state.settledBegin; i < state.settledEnd; i++)
+        {
+            if (state.numbers[i] != sorted[i])
+                return false;
+        }
+
+        return std::all_of(state.numbers.begin(), state.numbers.begin() + state.settledBegin,
+                           [&](int value) { return value <= sorted[state.settledBegin]; }) &&
+               std::all_of(state.numbers.begin() + state.settledEnd, state.numbers.end(),
+                           [&](int value) { return value >= sorted[state.settledEnd - 1]; });
+    }
+
+    struct Result
+    {
+        std::string name;
+        bool skipped;
+        long long comparisons;
+        double ms;
+        bool correct;
+    };
+}
+
+void runBenchmark(
+    int n,
+    int threadCount,
+    int k,
+    const std::map<std::string, std::function<Generator<Operation>(SortState &)>> &sortingAlgorithms)
+{
+    std::vector<int> input(n);
+
+    for (int i = 0; i < n; i++)
+        input[i] = i + 1;
+
+    std::shuffle(input.begin(), input.end(), std::mt19937(n));
+
+    std::cout << std::fixed << std::setprecision(2)
+              << "n = " << n << ", " << threadCount << " threads" << std::endl
+              << std::endl
+              << "Raw std::vector timings" << std::endl
+              << std::endl
+              << std::left << std::setw(16) << "Network"
+              << std::right << std::setw(8) << "Depth"
+              << std::setw(14) << "Size"
+              << std::setw(16) << "Sequential ms"
+              << std::setw(14) << "Parallel ms" << std::endl;
+
+    const std::map<std::string, std::function<Network(int)>> networks{
+        {"bitonic", bitonicNetwork},
+        {"oddeven", oddEvenMergeNetwork}
+    };
+
+    for (auto &[name, build] : networks)
+    {
+        const Network network = build(n);
+
+        std::vector<int> sequential(input);
+        const double sequentialMs = timeMs([&]() { runNetwork(sequential, network); });
+
+        std::vector<int> parallel(input);
+        const double parallelMs = timeMs([&]() { runNetworkParallel(parallel, network, threadCount); });
+
+        std::cout << std::left << std::setw(16) << name
+                  << std::right << std::setw(8) << network.layers.size()
+                  << std::setw(14) << network.size
+                  << std::setw(16) << sequentialMs
+                  << std::setw(14) << parallelMs
+                  << status(std::is_sorted(sequential.begin(), sequential.end()) &&
+                            std::is_sorted(parallel.begin(), parallel.end()))
+                  << std::endl;
+    }
+
+    // The standard library on the same input, so the networks have a sequential baseline
+    const std::map<std::string, std::function<void(std::vector<int> &)>> librarySorts{
+        {"std::sort", [](std::vector<int> &numbers) { std::sort(numbers.begin(), numbers.end()); }},
+        {"std::stable_sort", [](std::vector<int> &numbers) { std::stable_sort(numbers.begin(), numbers.end()); }}
+    };
+
+    for (auto &[name, librarySort] : librarySorts)
+    {
+        std::vector<int> sequential(input);
+        const double sequentialMs = timeMs([&]() { librarySort(sequential); });
+
+        std::cout << std::left << std::setw(16) << name
+                  << std::right << std::setw(8) << "-"
+                  << std::setw(14) << "-"
+                  << std::setw(16) << sequentialMs
+                  << std::setw(14) << "-"
+                  << status(std::is_sorted(sequential.begin(), sequential.end()))
+                  << std::endl;
+    }
+
+    std::vector<int> sorted(input);
+    std::sort(sorted.begin(), sorted.end());
+
+    std::vector<Result> results;
+
+    for (auto &[name, algorithm] : sortingAlgorithms)
+    {
+        if (name == "bogo" || (QUADRATIC.count(name) && n > QUADRATIC_LIMIT))
+        {
+            results.push_back(Result{name, true, 0, 0, true});
+            continue;
+        }
+
+        SortState state{CountingVector<int>(), 0, false, k, 0, 0, -1, 0, std::vector<int>()};
+        state.numbers.resize(n);
+        std::copy(input.begin(), input.end(), state.numbers.begin());
+
+        const double ms = timeMs([&]()
+        {
+            for (const Operation &op : algorithm(state))
+            {
+                if (op.type == Operation::Compare)
+                    state.comparisons++;
+                else if (op.type == Operation::Settle)
+                {
+                    state.settledBegin = op.first;
+                    state.settledEnd = op.second;
+                }
+            }
+        });
+
+        results.push_back(Result{name, false, state.comparisons, ms, settled(state, sorted)});
+    }
+
+    // Selection modes are compared against the full sort with the fewest
+    // comparisons and, separately, the fastest one
+    const auto fullSorts = [](const Result &result)
+    {
+        return !result.skipped && !SELECTION_ALGORITHMS.count(result.name);
+    };
+
+    const Result *comparisonBaseline = nullptr;
+    const Result *timeBaseline = nullptr;
+
+    for (const Result &result : results)
+    {
+        if (!fullSorts(result))
+            continue;
+
+        if (!comparisonBaseline || result.comparisons < comparisonBaseline->comparisons)
+            comparisonBaseline = &result;
+
+        if (!timeBaseline || result.ms < timeBaseline->ms)
+            timeBaseline = &result;
+    }
+
+    std::cout << std::endl
+              << "Timed through the visualizer's generators and CountingVector, not comparable with raw timings" << std::endl
+              << "k = " << k << " for ";
+
+    for (auto it = SELECTION_ALGORITHMS.begin(); it != SELECTION_ALGORITHMS.end(); ++it)
+        std::cout << (it == SELECTION_ALGORITHMS.begin() ? "" : ", ") << *it;
+
+    std::cout << std::endl;
+
+    if (comparisonBaseline && timeBaseline)
+        std::cout << "Comparisons % relative to " << comparisonBaseline->name
+                  << ", time % relative to " << timeBaseline->name << std::endl;
+
+    std::cout << std::endl
+              << std::left << std::setw(16) << "Algorithm"
+              << std::right << std::setw(14) << "Comparisons"
+              << std::setw(16) << "Time ms"
+              << std::setw(16) << "Comparisons %"
+              << std::setw(10) << "Time %" << std::endl;
+
+    for (const Result &result : results)
+    {
+        std::cout << std::left << std::setw(16) << result.name << std::right;
+
+        if (result.skipped)
+        {
+            std::cout << std::setw(14) << "-" << std::setw(16) << "skipped" << std::endl;
+            continue;
+        }
+
+        std::cout << std::setw(14) << result.comparisons
+                  << std::setw(16) << result.ms;
+
+        if (SELECTION_ALGORITHMS.count(result.name) && comparisonBaseline && comparisonBaseline->comparisons > 0 &&
+            timeBaseline && timeBaseline->ms > 0)
+            std::cout << std::setw(16) << 100.0 * result.comparisons / comparisonBaseline->comparisons
+                      << std::setw(10) << 100.0 * result.ms / timeBaseline->ms;
+
+        std::cout << status(result.correct) << std::endl;
+    }
+}
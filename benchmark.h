@@ -0,0 +1,21 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include "SortState.h"
+#include "Operation.h"
+#include "Generator.h"
+#include <map>
+#include <string>
+#include <functional>
+
+// Times the sorting networks sequentially and layer-parallel, then every
+// registered algorithm run to completion without visualization. Selection
+// algorithms settle k elements and report their comparisons relative to
+// the full sort with the fewest, and their time relative to the fastest.
+void runBenchmark(
+    int n,
+    int threadCount,
+    int k,
+    const std::map<std::string, std::function<Generator<Operation>(SortState &)>> &sortingAlgorithms);
+
+#endif // BENCHMARK_H
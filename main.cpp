@@ -2,7 +2,6 @@
 #include <SFML/Audio.hpp>
 #include <vector>
 #include <thread>
-#include <mutex>
 #include <chrono>
 #include <algorithm>
 #include <random>
@@ -10,14 +9,35 @@
 #include <string>
 #include <functional>
 #include <cmath>
+#include <map>
+#include <iterator>
+#include <limits>
+#include <atomic>
 #include "CountingVector.h"
 #include "sorts.h"
 #include "SortState.h"
+#include "SortRunner.h"
+#include "networks.h"
+#include "selection.h"
+#include "benchmark.h"
+#include "Hud.h"
+#include "PerfOverlay.h"
 
 // Global constants
 const int WIDTH{1200};
 const int HEIGHT{800};
 const int LIGHT_DURATION{50}; // In milliseconds
+const int HUD_HEIGHT{64};
+const int MAX_N{1 << 20};
+const int MAX_DELAY{1000}; // In milliseconds
+const int FRAME_BUDGET{12}; // Sorting time per frame at zero delay, in milliseconds
+const size_t MAX_HISTORY{1 << 20}; // Operations that can be stepped back
+const size_t PERF_HISTORY{240}; // Frames shown in the performance overlay
+
+const std::vector<std::string> DISTRIBUTIONS{"shuffled", "reversed", "nearly sorted", "few unique"};
+
+// Tones currently playing, shown in the performance overlay
+std::atomic<int> activeVoices{0};
 
 bool isNumber(const std::string &s)
 {
@@ -30,10 +50,16 @@ bool isNumber(const std::string &s)
     return true;
 }
 
+// Non-negative integer no larger than max, checked before stoi could overflow
+bool isNumberUpTo(const std::string &s, int max)
+{
+    return !s.empty() && isNumber(s) && s.size() <= 10 && std::stoll(s) <= max;
+}
+
 bool validateInput(
     int argc,
     char *argv[],
-    const std::map<std::string, std::function<void(SortState &, int)>> &sortingAlgorithms)
+    const std::map<std::string, std::function<Generator<Operation>(SortState &)>> &sortingAlgorithms)
 {
     if (argc < 4)
     {
@@ -56,7 +82,10 @@ bool validateInput(
                   << "  delay     Sorting delay in milliseconds." << std::endl
                   << std::endl
                   << "Example: " << std::endl
-                  << "  " << argv[0] << " bubble 25 50"
+                  << "  " << argv[0] << " bubble 25 50" << std::endl
+                  << std::endl
+                  << "Benchmark: " << std::endl
+                  << "  " << argv[0] << " --bench <n> [threads] [k]"
                   << std::endl;
 
         return false;
@@ -81,18 +110,18 @@ bool validateInput(
     }
 
     // Argument 2
-    if (!isNumber(argv[2]) || std::stoi(argv[2]) < 0)
+    if (!isNumberUpTo(argv[2], MAX_N))
     {
-        std::cerr << "Invalid input for n. Please provide a positive integer."
+        std::cerr << "Invalid input for n. Please provide an integer between 0 and " << MAX_N << "."
                   << std::endl;
 
         return false;
     }
 
     // Argument 3
-    if (!isNumber(argv[3]) || std::stoi(argv[3]) < 0)
+    if (!isNumberUpTo(argv[3], MAX_DELAY))
     {
-        std::cerr << "Invalid input for delay. Please provide a positive integer."
+        std::cerr << "Invalid input for delay. Please provide an integer between 0 and " << MAX_DELAY << "."
                   << std::endl;
 
         return false;
@@ -109,6 +138,8 @@ void playTone(int frequency, int sortingDelay)
     if (numSamples == 0)
         return;
 
+    activeVoices++;
+
     std::vector<sf::Int16> samples(numSamples);
 
     for (int i = 0; i < numSamples; i++)
@@ -126,6 +157,18 @@ void playTone(int frequency, int sortingDelay)
     sound.play();
 
     std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay * 10));
+
+    activeVoices--;
+}
+
+std::string title(const std::string &sortType, int k)
+{
+    const std::string name{std::string(1, toupper(sortType[0])) + sortType.substr(1)};
+
+    if (SELECTION_ALGORITHMS.count(sortType))
+        return name + " (k=" + std::to_string(k) + ") - ";
+
+    return name + " Sort - ";
 }
 
 void drawBars(
@@ -138,14 +181,23 @@ void drawBars(
     std::vector<int> &lastTimeAccessed)
 {
     // Don't draw bars if window is too small
-    if (window.getSize().y <= 40) return;
+    if (window.getSize().y <= HUD_HEIGHT) return;
 
-    for (int i = 0; i < state.numbers.size(); ++i)
+    // A single tone per frame, however many bars were accessed, keeps the
+    // number of sound threads bounded when many operations run in one frame
+    int toneIndex{-1};
+
+    // Play tone when checking index changes
+    if (checkingIndex != prevCheckingIndex)
     {
-        std::unique_lock<std::mutex> lock(state.mtx);
+        prevCheckingIndex = checkingIndex;
+        toneIndex = checkingIndex;
+    }
 
+    for (int i = 0; i < state.numbers.size(); ++i)
+    {
         const double barWidth{static_cast<double>(window.getSize().x) / state.numbers.size()};
-        const double barHeight{static_cast<double>(state.numbers[i] * (window.getSize().y - 40)) / state.numbers.size()};
+        const double barHeight{static_cast<double>(state.numbers[i] * (window.getSize().y - HUD_HEIGHT)) / state.numbers.size()};
 
         if (state.numbers.isAccessed(i))
         {
@@ -153,24 +205,19 @@ void drawBars(
             state.numbers.clearAccessed(i);
 
             // Play tone when a number changes
-            const int frequency = 1760 * (static_cast<double>(state.numbers[i]) / state.numbers.size());
-            std::thread playToneThread(playTone, frequency, sortingDelay);
-            playToneThread.detach();
+            if (toneIndex < 0)
+                toneIndex = i;
         }
 
-        if (checkingIndex != prevCheckingIndex)
-        {
-            prevCheckingIndex = checkingIndex;
-
-            // Play tone when checking index changes
-            const int frequency = 1760 * (static_cast<double>(state.numbers[checkingIndex]) / state.numbers.size());
-            std::thread playToneThread(playTone, frequency, sortingDelay);
-            playToneThread.detach();
-        }
+        sf::RectangleShape rect(sf::Vector2f(barWidth, barHeight));
 
-        lock.unlock();
+        // Elements already in their final position
+        if (i >= state.settledBegin && i < state.settledEnd)
+            rect.setFillColor(sf::Color(70, 130, 255));
 
-        sf::RectangleShape rect(sf::Vector2f(barWidth, barHeight));
+        // Comparators of the network layer being executed
+        if (state.activeLayer >= 0 && state.layerOf[i] == state.activeLayer)
+            rect.setFillColor(sf::Color::Yellow);
 
         // Light up the bar for LIGHT_DURATION milliseconds
         if (timeElapsed - lastTimeAccessed[i] < LIGHT_DURATION || i == checkingIndex)
@@ -183,116 +230,319 @@ void drawBars(
 
         window.draw(rect);
     }
+
+    if (toneIndex >= 0 && sortingDelay > 0)
+    {
+        const int frequency = 1760 * (static_cast<double>(state.numbers[toneIndex]) / state.numbers.size());
+        std::thread playToneThread(playTone, frequency, sortingDelay);
+        playToneThread.detach();
+    }
 }
 
-void verify(SortState &state, int &checkingIndex, int sortingDelay)
+// Refills the existing buffer in place so restarts don't reallocate
+void fillNumbers(SortState &state, int n, const std::string &distribution)
 {
-    for (int i = 0; i < state.numbers.size(); i++)
-    {
-        checkingIndex = i;
+    std::mt19937 gen(std::random_device{}());
 
-        std::unique_lock<std::mutex> lock(state.mtx);
+    state.numbers.resize(n);
+
+    for (int i = 0; i < n; i++)
+        state.numbers[i] = i + 1;
 
-        if (state.numbers[i] < state.numbers[i - 1])
+    if (distribution == "shuffled")
+    {
+        std::shuffle(state.numbers.begin(), state.numbers.end(), gen);
+    }
+    else if (distribution == "reversed")
+    {
+        std::reverse(state.numbers.begin(), state.numbers.end());
+    }
+    else if (distribution == "nearly sorted")
+    {
+        // Swap a few elements with close neighbours
+        std::uniform_int_distribution<> dist(0, std::max(n - 1, 0));
+
+        for (int i = 0; i < n / 20 + 1 && n > 1; i++)
         {
-            std::cerr << "Sorting failed." << std::endl;
-            exit(1);
+            const int a = dist(gen);
+            const int b = std::min(a + 1 + dist(gen) % 4, n - 1);
+            std::swap(state.numbers[a], state.numbers[b]);
         }
+    }
+    else if (distribution == "few unique")
+    {
+        const int buckets{8};
 
-        lock.unlock();
+        for (int i = 0; i < n; i++)
+            state.numbers[i] = std::max(1, (i * buckets / n + 1) * n / buckets);
 
-        std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
+        std::shuffle(state.numbers.begin(), state.numbers.end(), gen);
     }
 }
 
 int main(int argc, char *argv[])
 {
-    const std::map<std::string, std::function<void(SortState &, int)>>
+    const std::map<std::string, std::function<Generator<Operation>(SortState &)>>
         sortingAlgorithms{
             {"bubble", bubbleSort},
             {"selection", selectionSort},
             {"insertion", insertionSort},
             {"merge", mergeSort},
             {"quick", quickSort},
-            {"bogo", bogoSort}
+            {"bogo", bogoSort},
+            {"bitonic", bitonicSort},
+            {"oddeven", oddEvenMergeSort},
+            {"quickselect", quickSelect},
+            {"introselect", introSelect},
+            {"topk", topK},
+            {"partialsort", partialSort}
         };
 
+    // Headless timing run
+    if (argc >= 3 && std::string(argv[1]) == "--bench")
+    {
+        if (!isNumber(argv[2]) ||
+            (argc >= 4 && (!isNumber(argv[3]) || std::stoi(argv[3]) < 1)) ||
+            (argc >= 5 && (!isNumber(argv[4]) || std::stoi(argv[4]) < 1)))
+        {
+            std::cerr << "Usage: " << argv[0] << " --bench <n> [threads] [k]" << std::endl;
+            return 1;
+        }
+
+        const int benchN{std::stoi(argv[2])};
+        const int threadCount{argc >= 4 ? std::stoi(argv[3]) : std::max(1, static_cast<int>(std::thread::hardware_concurrency()))};
+        const int benchK{argc >= 5 ? std::stoi(argv[4]) : std::max(1, benchN / 100)};
+        runBenchmark(benchN, threadCount, benchK, sortingAlgorithms);
+
+        return 0;
+    }
+
     if (!validateInput(argc, argv, sortingAlgorithms))
         return 1;
 
-    const std::string sortType{argv[1]};
-    const int n{std::stoi(argv[2])};
-    const int sortingDelay{std::stoi(argv[3])};
+    std::string sortType{argv[1]};
+    int n{std::stoi(argv[2])};
+    int k{std::max(1, n / 10)};
+    int sortingDelay{std::stoi(argv[3])};
+    int distribution{0};
+    bool paused{false};
 
     int timeElapsed{0};
+    int lastFrame{0};
+    int sortStart{0};
     int sortTime{0};
-    int checkingIndex{-1};
+    int pauseStart{0};
+    int pausedTime{0};
     int prevCheckingIndex{-1};
+    double pendingOperations{0};
 
-    // Shared state
     SortState state{
         CountingVector<int>(), // numbers
-        std::mutex(),          // mtx
         0,                     // comparisons
         false,                 // sortingComplete
-        true                   // running
+        std::min(k, n),        // k
+        0,                     // settledBegin
+        0,                     // settledEnd
+        -1,                    // activeLayer
+        0,                     // layerCount
+        std::vector<int>()     // layerOf
     };
 
-    for (int i = 0; i < n; i++)
-        state.numbers.push_back(i + 1);
-
-    std::shuffle(state.numbers.begin(), state.numbers.end(), std::random_device());
+    fillNumbers(state, n, DISTRIBUTIONS[distribution]);
 
     // Last time each index was accessed
     std::vector<int> lastTimeAccessed(n, 0);
 
+    // Sort is stepped on the render thread, so no locking is needed
+    SortRunner runner(state, MAX_HISTORY);
+    runner.start(sortingAlgorithms.at(sortType)(state));
+
     sf::RenderWindow window(sf::VideoMode(WIDTH, HEIGHT), "Sorting Visualization");
 
+    // Loaded once and kept for the lifetime of the window, including restarts
     sf::Font font;
     font.loadFromFile("NotoSansMono.ttf");
 
-    sf::Text text;
-    text.setFont(font);
-    text.setCharacterSize(20);
-    text.setFillColor(sf::Color::White);
-    text.setPosition(12, 8);
+    // Status line, only changed fields are re-laid out each frame
+    Hud status(font, 20, sf::Vector2f(12, 8));
+    const int titleField{status.addField()};
+    const int comparisonsField{status.addField()};
+    status.addField(" comparisons, ");
+    const int accessesField{status.addField()};
+    status.addField(" array accesses, ");
+    const int elapsedField{status.addField()};
+    status.addField("ms elapsed");
+    const int layerField{status.addField()};
+    const int pausedField{status.addField()};
+    int shownLayer{-1};
+
+    // Control panel
+    Hud controls(font, 14, sf::Vector2f(12, 38));
+    controls.addField("[Space] pause  [,/.] step  [R] restart  [Left/Right] algo  [Up/Down] n=");
+    const int nField{controls.addField()};
+    controls.addField("  [+/-] delay=");
+    const int delayField{controls.addField()};
+    controls.addField("ms  [D] ");
+    const int distributionField{controls.addField()};
+    controls.addField("  [[/]] k=");
+    const int kField{controls.addField()};
+    controls.addField("  [P] perf");
+
+    PerfOverlay perfOverlay(font, PERF_HISTORY);
+    bool showPerf{false};
+
+    status.set(titleField, title(sortType, state.k));
 
     sf::Clock clock;
+    sf::Clock frameClock;
 
-    // Sort on a separate thread
-    std::thread sortThread(std::ref(sortingAlgorithms.at(sortType)), std::ref(state), sortingDelay);
+    // Discards the current run and starts a new one, reusing all buffers
+    auto restart = [&]()
+    {
+        fillNumbers(state, n, DISTRIBUTIONS[distribution]);
+        lastTimeAccessed.assign(n, 0);
+
+        state.numbers.resetAccessCount();
+        state.comparisons = 0;
+        state.sortingComplete = false;
+        state.k = std::min(k, n);
+
+        runner.start(sortingAlgorithms.at(sortType)(state));
+        status.set(titleField, title(sortType, state.k));
+
+        sortStart = clock.getElapsedTime().asMilliseconds();
+        sortTime = 0;
+        pauseStart = sortStart;
+        pausedTime = 0;
+        prevCheckingIndex = -1;
+        pendingOperations = 0;
+    };
 
     while (window.isOpen())
     {
+        int operations{0};
+
         sf::Event event;
         while (window.pollEvent(event))
         {
             if (event.type == sf::Event::Closed)
             {
-                // Signal thread to stop
-                state.running = false;
-                sortThread.join();
-
                 window.close();
             }
             else if (event.type == sf::Event::Resized)
             {
                 window.setView(sf::View(sf::FloatRect(0, 0, event.size.width, event.size.height)));
             }
+            else if (event.type == sf::Event::KeyPressed)
+            {
+                switch (event.key.code)
+                {
+                case sf::Keyboard::Space:
+                    paused = !paused;
+
+                    if (paused)
+                        pauseStart = clock.getElapsedTime().asMilliseconds();
+                    else
+                        pausedTime += clock.getElapsedTime().asMilliseconds() - pauseStart;
+                    break;
+                case sf::Keyboard::Period:
+                    if (paused)
+                        operations += runner.step();
+                    break;
+                case sf::Keyboard::Comma:
+                    if (paused)
+                        runner.stepBack();
+                    break;
+                case sf::Keyboard::Equal:
+                case sf::Keyboard::Add:
+                    sortingDelay = std::min(std::max(sortingDelay * 2, 1), MAX_DELAY);
+                    break;
+                case sf::Keyboard::Hyphen:
+                case sf::Keyboard::Subtract:
+                    sortingDelay /= 2;
+                    break;
+                case sf::Keyboard::R:
+                    restart();
+                    break;
+                case sf::Keyboard::Left:
+                case sf::Keyboard::Right:
+                {
+                    auto it = sortingAlgorithms.find(sortType);
+
+                    if (event.key.code == sf::Keyboard::Right)
+                        it = std::next(it) == sortingAlgorithms.end() ? sortingAlgorithms.begin() : std::next(it);
+                    else
+                        it = std::prev(it == sortingAlgorithms.begin() ? sortingAlgorithms.end() : it);
+
+                    sortType = it->first;
+                    restart();
+                    break;
+                }
+                case sf::Keyboard::Up:
+                    n = std::min(std::max(n * 2, 1), MAX_N);
+                    restart();
+                    break;
+                case sf::Keyboard::Down:
+                    n = std::max(n / 2, 1);
+                    restart();
+                    break;
+                case sf::Keyboard::D:
+                    distribution = (distribution + 1) % DISTRIBUTIONS.size();
+                    restart();
+                    break;
+                case sf::Keyboard::LBracket:
+                    k = std::max(std::min(k, n) / 2, 1);
+                    restart();
+                    break;
+                case sf::Keyboard::RBracket:
+                    k = std::max(std::min(k * 2, n), 1);
+                    restart();
+                    break;
+                case sf::Keyboard::P:
+                    showPerf = !showPerf;
+                    break;
+                default:
+                    break;
+                }
+            }
         }
 
         timeElapsed = clock.getElapsedTime().asMilliseconds();
 
-        // Sorting complete
-        if (state.sortingComplete && sortTime == 0)
+        // Run as many operations as the delay allows for this frame, or as
+        // many as fit in the frame budget when there is no delay
+        sf::Clock sortClock;
+
+        if (!paused && !runner.isFinished())
         {
-            sortTime = timeElapsed;
+            if (sortingDelay == 0)
+            {
+                operations += runner.run(std::numeric_limits<int>::max(), std::chrono::milliseconds(FRAME_BUDGET));
+            }
+            else
+            {
+                pendingOperations += static_cast<double>(timeElapsed - lastFrame) / sortingDelay;
+
+                const int dueOperations = static_cast<int>(pendingOperations);
+                pendingOperations -= dueOperations;
 
-            // Begin verification
-            std::thread verifyingThread(verify, std::ref(state), std::ref(checkingIndex), sortingDelay);
-            verifyingThread.detach();
+                operations += runner.run(dueOperations, std::chrono::milliseconds(FRAME_BUDGET));
+            }
         }
 
+        const float sortTimeMs{sortClock.getElapsedTime().asMicroseconds() / 1000.0f};
+
+        lastFrame = timeElapsed;
+
+        // Time spent sorting, excluding time spent paused
+        const int sortElapsed{timeElapsed - sortStart - pausedTime - (paused ? timeElapsed - pauseStart : 0)};
+
+        // Sorting complete
+        if (state.sortingComplete && sortTime == 0)
+            sortTime = sortElapsed;
+
+        sf::Clock drawClock;
+
         window.clear();
 
         // Draw bars
@@ -301,18 +551,48 @@ int main(int argc, char *argv[])
             state,
             timeElapsed,
             sortingDelay,
-            checkingIndex,
+            runner.getCheckingIndex(),
             prevCheckingIndex,
             lastTimeAccessed);
 
         // Draw text
-        text.setString(std::string(1, toupper(sortType[0])) + sortType.substr(1) + " Sort - " +
-                       std::to_string(state.comparisons) + " comparisons, " +
-                       std::to_string(state.numbers.getAccessCount()) + " array accesses, " +
-                       std::to_string(state.sortingComplete ? sortTime : timeElapsed) + "ms elapsed");
-        window.draw(text);
+        status.set(comparisonsField, state.comparisons);
+        status.set(accessesField, state.numbers.getAccessCount());
+        status.set(elapsedField, state.sortingComplete ? sortTime : sortElapsed);
+        if (state.activeLayer != shownLayer)
+        {
+            shownLayer = state.activeLayer;
+            status.set(layerField, shownLayer < 0 ? std::string() :
+                       ", layer " + std::to_string(shownLayer + 1) + "/" + std::to_string(state.layerCount));
+        }
+
+        status.set(pausedField, paused ? " (paused)" : "");
+        status.draw(window);
+
+        // Draw control panel
+        controls.set(nField, n);
+        controls.set(delayField, sortingDelay);
+        controls.set(distributionField, DISTRIBUTIONS[distribution]);
+        controls.set(kField, std::min(k, n));
+        controls.draw(window);
+
+        const float drawTimeMs{drawClock.getElapsedTime().asMicroseconds() / 1000.0f};
+
+        if (showPerf)
+            perfOverlay.draw(window, sf::Vector2f(window.getSize().x - perfOverlay.getSize().x - 12, HUD_HEIGHT));
 
         window.display();
+
+        // Measured at the end so the rate divides this frame's operations by this frame's time
+        const float frameTime{frameClock.restart().asMicroseconds() / 1000.0f};
+
+        perfOverlay.push(PerfOverlay::Sample{
+            frameTime,
+            drawTimeMs,
+            sortTimeMs,
+            frameTime > 0 ? operations * 1000.0f / frameTime : 0,
+            static_cast<float>(activeVoices)
+        });
     }
 
     return 0;
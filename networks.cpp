@@ -0,0 +1,240 @@
+#include "networks.h"
+#include "sorts.h"
+#include <algorithm>
+#include <barrier>
+#include <thread>
+
+namespace
+{
+    int nextPowerOfTwo(int n)
+    {
+        int p = 1;
+
+        while (p < n)
+            p <<= 1;
+
+        return p;
+    }
+
+    // Drops layers left empty by n not being a power of two and counts comparators
+    void finalize(Network &network)
+    {
+        std::vector<NetworkLayer> active;
+        network.size = 0;
+
+        for (const NetworkLayer &layer : network.layers)
+        {
+            long long layerSize = 0;
+
+            for (int block = 0; block < layer.blocks; block++)
+            {
+                int base, first, last;
+
+                if (blockRange(network, layer, block, base, first, last))
+                    layerSize += last - first;
+            }
+
+            if (layerSize > 0)
+                active.push_back(layer);
+
+            network.size += layerSize;
+        }
+
+        network.layers = std::move(active);
+    }
+
+    // Runs comparators [begin, end) of a layer, counted across blocks
+    void runLayerRange(int *data, const Network &network, const NetworkLayer &layer, int begin, int end)
+    {
+        const int width = layer.width;
+        int c = begin;
+
+        while (c < end)
+        {
+            const int block = c / width;
+            const int blockEnd = std::min(end - block * width, width);
+            int base, first, last;
+
+            if (blockRange(network, layer, block, base, first, last))
+            {
+                const int from = std::max(c - block * width, first);
+                const int to = std::min(blockEnd, last);
+
+                // Branchless min/max over contiguous runs, which GCC only vectorizes
+                // when AVX2 is available (make release builds with -march=native)
+                if (layer.mirrored)
+                {
+                    int *lo = data + base;
+                    int *hi = data + base + 2 * width - 1;
+
+                    for (int o = from; o < to; o++)
+                    {
+                        const int a = lo[o];
+                        const int b = hi[-o];
+                        lo[o] = std::min(a, b);
+                        hi[-o] = std::max(a, b);
+                    }
+                }
+                else
+                {
+                    int *lo = data + base;
+                    int *hi = data + base + width;
+
+                    for (int o = from; o < to; o++)
+                    {
+                        const int a = lo[o];
+                        const int b = hi[o];
+                        lo[o] = std::min(a, b);
+                        hi[o] = std::max(a, b);
+                    }
+                }
+            }
+
+            c = (block + 1) * width;
+        }
+    }
+}
+
+// Built for the next power of two with every comparator ascending, so the
+// padding behaves as +infinity and comparators touching it can be dropped
+Network bitonicNetwork(int n)
+{
+    const int p = nextPowerOfTwo(n);
+    Network network{n, {}, 0};
+
+    for (int k = 2; k <= p; k <<= 1)
+    {
+        network.layers.push_back(NetworkLayer{k / 2, 0, 0, true, p / k});
+
+        for (int j = k / 4; j >= 1; j >>= 1)
+            network.layers.push_back(NetworkLayer{j, 0, 0, false, p / (2 * j)});
+    }
+
+    finalize(network);
+
+    return network;
+}
+
+// Batcher's odd-even merge sort, padded to a power of two like bitonicNetwork
+Network oddEvenMergeNetwork(int n)
+{
+    const int p = nextPowerOfTwo(n);
+    Network network{n, {}, 0};
+
+    for (int q = 1; q < p; q <<= 1)
+    {
+        for (int k = q; k >= 1; k >>= 1)
+        {
+            const int start = k % q;
+
+            if (p - 1 - k < start)
+                continue;
+
+            network.layers.push_back(NetworkLayer{k, start, 2 * q, false, (p - 1 - k - start) / (2 * k) + 1});
+        }
+    }
+
+    finalize(network);
+
+    return network;
+}
+
+bool blockRange(const Network &network, const NetworkLayer &layer, int block, int &base, int &first, int &last)
+{
+    const int width = layer.width;
+    base = layer.start + block * 2 * width;
+
+    // Partners would fall in different merge groups
+    if (layer.group > 0 && (base + width) % layer.group == 0)
+        return false;
+
+    if (layer.mirrored)
+    {
+        first = std::max(0, base + 2 * width - network.n);
+        last = width;
+    }
+    else
+    {
+        first = 0;
+        last = std::min(width, network.n - base - width);
+    }
+
+    return first < last;
+}
+
+void runNetwork(std::vector<int> &numbers, const Network &network)
+{
+    for (const NetworkLayer &layer : network.layers)
+        runLayerRange(numbers.data(), network, layer, 0, layer.blocks * layer.width);
+}
+
+// Splits every layer evenly between threads, which meet at a barrier before the next layer
+void runNetworkParallel(std::vector<int> &numbers, const Network &network, int threadCount)
+{
+    std::barrier sync(threadCount);
+
+    auto worker = [&](int id)
+    {
+        for (const NetworkLayer &layer : network.layers)
+        {
+            const long long total = static_cast<long long>(layer.blocks) * layer.width;
+            const int begin = static_cast<int>(total * id / threadCount);
+            const int end = static_cast<int>(total * (id + 1) / threadCount);
+
+            runLayerRange(numbers.data(), network, layer, begin, end);
+
+            sync.arrive_and_wait();
+        }
+    };
+
+    std::vector<std::thread> threads;
+
+    for (int id = 1; id < threadCount; id++)
+        threads.emplace_back(worker, id);
+
+    worker(0);
+
+    for (std::thread &thread : threads)
+        thread.join();
+}
+
+Generator<Operation> networkSort(SortState &state, Network network)
+{
+    const int layerCount = network.layers.size();
+
+    for (int index = 0; index < layerCount; index++)
+    {
+        co_yield layer(index, layerCount);
+
+        const NetworkLayer &current = network.layers[index];
+
+        for (int block = 0; block < current.blocks; block++)
+        {
+            int base, first, last;
+
+            if (!blockRange(network, current, block, base, first, last))
+                continue;
+
+            for (int o = first; o < last; o++)
+            {
+                const int lo = base + o;
+                const int hi = current.mirrored ? base + 2 * current.width - 1 - o : base + current.width + o;
+
+                co_yield compare(lo, hi);
+
+                if (state.numbers[lo] > state.numbers[hi])
+                    co_yield swap(state, lo, hi);
+            }
+        }
+    }
+}
+
+Generator<Operation> bitonicSort(SortState &state)
+{
+    co_yield networkSort(state, bitonicNetwork(state.numbers.size()));
+}
+
+Generator<Operation> oddEvenMergeSort(SortState &state)
+{
+    co_yield networkSort(state, oddEvenMergeNetwork(state.numbers.size()));
+}
@@ -0,0 +1,43 @@
+#ifndef NETWORKS_H
+#define NETWORKS_H
+
+#include "SortState.h"
+#include "Operation.h"
+#include "Generator.h"
+#include <vector>
+
+// A layer of independent compare-exchanges, stored implicitly so networks
+// for large n don't need a comparator list. Comparators are grouped into
+// blocks of `width`; block b pairs the halves of [start + 2 * width * b,
+// start + 2 * width * (b + 1)), front to front or front to back if mirrored.
+struct NetworkLayer
+{
+    int width;
+    int start;
+    int group; // Blocks that would straddle a multiple of group are skipped, 0 for none
+    bool mirrored;
+    int blocks;
+};
+
+struct Network
+{
+    int n;
+    std::vector<NetworkLayer> layers;
+    long long size;
+};
+
+Network bitonicNetwork(int n);
+Network oddEvenMergeNetwork(int n);
+
+// Active comparators of a block as offsets [first, last), false if none
+bool blockRange(const Network &network, const NetworkLayer &layer, int block, int &base, int &first, int &last);
+
+void runNetwork(std::vector<int> &numbers, const Network &network);
+void runNetworkParallel(std::vector<int> &numbers, const Network &network, int threadCount);
+
+// Visualization, each layer starts with a Layer operation so it runs as one step
+Generator<Operation> networkSort(SortState &state, Network network);
+Generator<Operation> bitonicSort(SortState &state);
+Generator<Operation> oddEvenMergeSort(SortState &state);
+
+#endif // NETWORKS_H
@@ -0,0 +1,301 @@
+#include "selection.h"
+#include "sorts.h"
+#include <algorithm>
+#include <random>
+
+const std::set<std::string> SELECTION_ALGORITHMS{"quickselect", "introselect", "topk", "partialsort"};
+
+namespace
+{
+    // k clamped to the array, 0 when there is nothing to select
+    int rank(SortState &state)
+    {
+        return std::min(std::max(state.k, 1), state.numbers.size());
+    }
+}
+
+Generator<Operation> partition3(SortState &state, int low, int high, int &lt, int &gt)
+{
+    const int pivot = state.numbers[low];
+    co_yield read(low);
+
+    lt = low;
+    gt = high;
+    int i = low + 1;
+
+    while (i <= gt)
+    {
+        co_yield compare(i, lt);
+
+        if (state.numbers[i] < pivot)
+        {
+            co_yield swap(state, lt, i);
+            lt++;
+            i++;
+            continue;
+        }
+
+        co_yield compare(i, lt);
+
+        if (state.numbers[i] > pivot)
+        {
+            co_yield swap(state, i, gt);
+            gt--;
+        }
+        else
+        {
+            i++;
+        }
+    }
+}
+
+Generator<Operation> insertionRange(SortState &state, int low, int high)
+{
+    for (int i = low + 1; i <= high; i++)
+    {
+        for (int j = i; j > low; j--)
+        {
+            co_yield compare(j - 1, j);
+
+            if (state.numbers[j - 1] <= state.numbers[j])
+                break;
+
+            co_yield swap(state, j - 1, j);
+        }
+    }
+}
+
+// Random pivots, expected linear time
+Generator<Operation> quickSelectHelper(SortState &state, int low, int high, int target, std::mt19937 &gen)
+{
+    while (low < high)
+    {
+        const int pivotIndex = std::uniform_int_distribution<>(low, high)(gen);
+
+        if (pivotIndex != low)
+            co_yield swap(state, low, pivotIndex);
+
+        int lt, gt;
+
+        co_yield partition3(state, low, high, lt, gt);
+
+        if (target < lt)
+            high = lt - 1;
+        else if (target > gt)
+            low = gt + 1;
+        else
+            break;
+    }
+}
+
+// Quick sort with random pivots and a three-way partition, so runs of
+// equal keys are settled in one pass instead of recursing into them
+Generator<Operation> quickSort3Helper(SortState &state, int low, int high, std::mt19937 &gen)
+{
+    if (low >= high)
+        co_return;
+
+    const int pivotIndex = std::uniform_int_distribution<>(low, high)(gen);
+
+    if (pivotIndex != low)
+        co_yield swap(state, low, pivotIndex);
+
+    int lt, gt;
+
+    co_yield partition3(state, low, high, lt, gt);
+
+    co_yield quickSort3Helper(state, low, lt - 1, gen);
+    co_yield quickSort3Helper(state, gt + 1, high, gen);
+}
+
+Generator<Operation> quickSelect(SortState &state)
+{
+    const int k = rank(state);
+
+    if (k == 0)
+        co_return;
+
+    std::mt19937 gen(std::random_device{}());
+
+    co_yield quickSelectHelper(state, 0, state.numbers.size() - 1, k - 1, gen);
+
+    co_yield settle(k - 1, k);
+}
+
+// Moves the median of each group of five to the front and selects the
+// median of those, which is guaranteed to split the range reasonably
+Generator<Operation> medianOfMedians(SortState &state, int low, int high, int &pivotIndex)
+{
+    if (high - low < 5)
+    {
+        co_yield insertionRange(state, low, high);
+
+        pivotIndex = low + (high - low) / 2;
+        co_return;
+    }
+
+    int medians = low;
+
+    for (int group = low; group <= high; group += 5)
+    {
+        const int groupEnd = std::min(group + 4, high);
+
+        co_yield insertionRange(state, group, groupEnd);
+
+        const int median = group + (groupEnd - group) / 2;
+
+        if (median != medians)
+            co_yield swap(state, median, medians);
+
+        medians++;
+    }
+
+    pivotIndex = low + (medians - 1 - low) / 2;
+
+    co_yield introSelectHelper(state, low, medians - 1, pivotIndex, 0);
+}
+
+// Median of three pivots until depthLimit partitions have been spent, then
+// median of medians for a linear worst case
+Generator<Operation> introSelectHelper(SortState &state, int low, int high, int target, int depthLimit)
+{
+    while (low < high)
+    {
+        int pivotIndex;
+
+        if (depthLimit > 0)
+        {
+            depthLimit--;
+
+            const int mid = low + (high - low) / 2;
+            co_yield compare(low, mid);
+            co_yield compare(mid, high);
+            co_yield compare(low, high);
+
+            const int a = state.numbers[low];
+            const int b = state.numbers[mid];
+            const int c = state.numbers[high];
+
+            if ((a <= b && b <= c) || (c <= b && b <= a))
+                pivotIndex = mid;
+            else if ((b <= a && a <= c) || (c <= a && a <= b))
+                pivotIndex = low;
+            else
+                pivotIndex = high;
+        }
+        else
+        {
+            co_yield medianOfMedians(state, low, high, pivotIndex);
+        }
+
+        if (pivotIndex != low)
+            co_yield swap(state, low, pivotIndex);
+
+        int lt, gt;
+
+        co_yield partition3(state, low, high, lt, gt);
+
+        if (target < lt)
+            high = lt - 1;
+        else if (target > gt)
+            low = gt + 1;
+        else
+            break;
+    }
+}
+
+Generator<Operation> introSelect(SortState &state)
+{
+    const int k = rank(state);
+
+    if (k == 0)
+        co_return;
+
+    int depthLimit = 0;
+
+    for (int size = state.numbers.size(); size > 1; size >>= 1)
+        depthLimit += 2;
+
+    co_yield introSelectHelper(state, 0, state.numbers.size() - 1, k - 1, depthLimit);
+
+    co_yield settle(k - 1, k);
+}
+
+// Max-heap sift down within the first size elements
+Generator<Operation> siftDown(SortState &state, int root, int size)
+{
+    while (2 * root + 1 < size)
+    {
+        int child = 2 * root + 1;
+
+        if (child + 1 < size)
+        {
+            co_yield compare(child, child + 1);
+
+            if (state.numbers[child] < state.numbers[child + 1])
+                child++;
+        }
+
+        co_yield compare(root, child);
+
+        if (state.numbers[root] >= state.numbers[child])
+            co_return;
+
+        co_yield swap(state, root, child);
+        root = child;
+    }
+}
+
+// Keeps the k smallest seen so far in a max-heap at the front, then sorts it
+Generator<Operation> topK(SortState &state)
+{
+    const int k = rank(state);
+
+    if (k == 0)
+        co_return;
+
+    for (int i = k / 2 - 1; i >= 0; i--)
+        co_yield siftDown(state, i, k);
+
+    for (int i = k; i < state.numbers.size(); i++)
+    {
+        co_yield compare(i, 0);
+
+        if (state.numbers[i] < state.numbers[0])
+        {
+            co_yield swap(state, i, 0);
+
+            co_yield siftDown(state, 0, k);
+        }
+    }
+
+    // Heap sort the front, settling from the back
+    for (int end = k - 1; end > 0; end--)
+    {
+        co_yield swap(state, 0, end);
+        co_yield settle(end, k);
+
+        co_yield siftDown(state, 0, end);
+    }
+
+    co_yield settle(0, k);
+}
+
+// Selects the k-th smallest, then sorts everything before it
+Generator<Operation> partialSort(SortState &state)
+{
+    const int k = rank(state);
+
+    if (k == 0)
+        co_return;
+
+    std::mt19937 gen(std::random_device{}());
+
+    co_yield quickSelectHelper(state, 0, state.numbers.size() - 1, k - 1, gen);
+
+    co_yield settle(k - 1, k);
+
+    co_yield quickSort3Helper(state, 0, k - 2, gen);
+
+    co_yield settle(0, k);
+}
@@ -0,0 +1,39 @@
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include "SortState.h"
+#include "Operation.h"
+#include "Generator.h"
+#include <random>
+#include <set>
+#include <string>
+
+// Selection algorithms only do enough work to settle state.k elements.
+// quickSelect and introSelect place the k-th smallest at index k - 1 with
+// smaller elements before it; topK and partialSort leave the k smallest
+// sorted at the front.
+
+// Registry names of the selection algorithms
+extern const std::set<std::string> SELECTION_ALGORITHMS;
+
+// Three-way partition around numbers[low], equal elements end up in [lt, gt]
+Generator<Operation> partition3(SortState &state, int low, int high, int &lt, int &gt);
+Generator<Operation> insertionRange(SortState &state, int low, int high);
+
+// Random pivots drawn from one engine per run, shared down the recursion
+Generator<Operation> quickSelectHelper(SortState &state, int low, int high, int target, std::mt19937 &gen);
+Generator<Operation> quickSort3Helper(SortState &state, int low, int high, std::mt19937 &gen);
+Generator<Operation> quickSelect(SortState &state);
+
+// Introselect, falls back to median of medians when partitioning goes badly
+Generator<Operation> medianOfMedians(SortState &state, int low, int high, int &pivotIndex);
+Generator<Operation> introSelectHelper(SortState &state, int low, int high, int target, int depthLimit);
+Generator<Operation> introSelect(SortState &state);
+
+// Heap based top-k
+Generator<Operation> siftDown(SortState &state, int root, int size);
+Generator<Operation> topK(SortState &state);
+
+Generator<Operation> partialSort(SortState &state);
+
+#endif // SELECTION_H
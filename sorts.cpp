@@ -1,37 +1,59 @@
 #include "sorts.h"
-#include <thread>
-#include <mutex>
-#include <chrono>
 #include <random>
+#include <vector>
+#include <iostream>
+#include <cstdlib>
 
-void bubbleSort(SortState &state, int sortingDelay)
+Operation compare(int first, int second)
+{
+    return Operation{Operation::Compare, first, second, 0, 0};
+}
+
+Operation read(int index)
+{
+    return Operation{Operation::Read, index, -1, 0, 0};
+}
+
+Operation swap(SortState &state, int first, int second)
+{
+    std::swap(state.numbers[first], state.numbers[second]);
+
+    return Operation{Operation::Swap, first, second, 0, 0};
+}
+
+Operation write(SortState &state, int index, int value)
+{
+    const int oldValue = state.numbers[index];
+    state.numbers[index] = value;
+
+    return Operation{Operation::Write, index, -1, oldValue, value};
+}
+
+Operation settle(int first, int last)
+{
+    return Operation{Operation::Settle, first, last, 0, 0};
+}
+
+Operation layer(int index, int count)
+{
+    return Operation{Operation::Layer, index, count, 0, 0};
+}
+
+Generator<Operation> bubbleSort(SortState &state)
 {
     for (int i = 0; i < state.numbers.size(); i++)
     {
         for (int j = 0; j < state.numbers.size() - i - 1; j++)
         {
-            std::unique_lock<std::mutex> lock(state.mtx);
-            state.numbers.enableAccessCounting();
+            co_yield compare(j, j + 1);
 
             if (state.numbers[j] > state.numbers[j + 1])
-                std::swap(state.numbers[j], state.numbers[j + 1]);
-
-            state.comparisons++;
-
-            state.numbers.disableAccessCounting();
-            lock.unlock();
-
-            if (!state.running)
-                return;
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
+                co_yield swap(state, j, j + 1);
         }
     }
-
-    state.sortingComplete = true;
 }
 
-void selectionSort(SortState &state, int sortingDelay)
+Generator<Operation> selectionSort(SortState &state)
 {
     for (int i = 0; i < state.numbers.size() - 1; i++)
     {
@@ -39,91 +61,44 @@ void selectionSort(SortState &state, int sortingDelay)
 
         for (int j = i + 1; j < state.numbers.size(); j++)
         {
-            std::unique_lock<std::mutex> lock(state.mtx);
-            state.numbers.enableAccessCounting();
+            co_yield compare(j, minIndex);
 
             if (state.numbers[j] < state.numbers[minIndex])
                 minIndex = j;
-
-            state.comparisons++;
-
-            state.numbers.disableAccessCounting();
-            lock.unlock();
-
-            if (!state.running)
-                return;
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
         }
 
         if (i != minIndex)
-        {
-            std::lock_guard<std::mutex> lock(state.mtx);
-            state.numbers.enableAccessCounting();
-
-            std::swap(state.numbers[i], state.numbers[minIndex]);
-
-            state.numbers.disableAccessCounting();
-        }
+            co_yield swap(state, i, minIndex);
     }
-
-    state.sortingComplete = true;
 }
 
-void insertionSort(SortState &state, int sortingDelay)
+Generator<Operation> insertionSort(SortState &state)
 {
     for (int i = 1; i < state.numbers.size(); i++)
     {
-        std::unique_lock<std::mutex> lock(state.mtx);
-        state.numbers.enableAccessCounting();
-
         int temp = state.numbers[i];
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
+        co_yield read(i);
 
         int j = i - 1;
 
-        // Using a while true loop so the mutex is locked before checking
-        while (true)
+        while (j >= 0)
         {
-            std::unique_lock<std::mutex> lock(state.mtx);
-            state.numbers.enableAccessCounting();
+            co_yield compare(j, j + 1);
 
-            if (j < 0 || temp >= state.numbers[j])
-            {
-                state.numbers.disableAccessCounting();
-                lock.unlock();
+            if (temp >= state.numbers[j])
                 break;
-            }
 
-            state.numbers[j + 1] = state.numbers[j];
-            state.comparisons++;
+            co_yield write(state, j + 1, state.numbers[j]);
 
             j -= 1;
-
-            state.numbers.disableAccessCounting();
-            lock.unlock();
-
-            if (!state.running)
-                return;
-
-            std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
         }
 
-        lock.lock();
-        state.numbers.enableAccessCounting();
-
-        state.numbers[j + 1] = temp;
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
+        if (j + 1 != i)
+            co_yield write(state, j + 1, temp);
     }
-
-    state.sortingComplete = true;
 }
 
-void merge(SortState &state, int sortingDelay, int left, int mid, int right)
+Generator<Operation> merge(SortState &state, int left, int mid, int right)
 {
     int n1 = mid - left + 1;
     int n2 = right - mid;
@@ -133,248 +108,170 @@ void merge(SortState &state, int sortingDelay, int left, int mid, int right)
 
     for (int i = 0; i < n1; i++)
     {
-        std::unique_lock<std::mutex> lock(state.mtx);
-        state.numbers.enableAccessCounting();
-
         L.push_back(state.numbers[left + i]);
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
+        co_yield read(left + i);
     }
 
     for (int i = 0; i < n2; i++)
     {
-        std::unique_lock<std::mutex> lock(state.mtx);
-        state.numbers.enableAccessCounting();
-
         R.push_back(state.numbers[mid + 1 + i]);
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
+        co_yield read(mid + 1 + i);
     }
 
     int i = 0;
     int j = 0;
     int k = left;
 
-    while (true)
+    while (i < n1 && j < n2)
     {
-        std::unique_lock<std::mutex> lock(state.mtx);
-        state.numbers.enableAccessCounting();
-
-        if (i >= n1 || j >= n2)
-        {
-            state.numbers.disableAccessCounting();
-            break;
-        }
+        co_yield compare(left + i, mid + 1 + j);
 
         if (L[i] <= R[j])
         {
-            state.numbers[k] = L[i];
+            co_yield write(state, k, L[i]);
             i++;
         }
         else
         {
-            state.numbers[k] = R[j];
+            co_yield write(state, k, R[j]);
             j++;
         }
 
         k++;
-
-        state.comparisons++;
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
-
-        if (!state.running)
-            return;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
     }
 
     while (i < n1)
     {
-        std::unique_lock<std::mutex> lock(state.mtx);
-        state.numbers.enableAccessCounting();
-
-        state.numbers[k] = L[i];
+        co_yield write(state, k, L[i]);
         i++;
         k++;
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
-
-        if (!state.running)
-            return;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
     }
 
     while (j < n2)
     {
-        std::unique_lock<std::mutex> lock(state.mtx);
-        state.numbers.enableAccessCounting();
-
-        state.numbers[k] = R[j];
+        co_yield write(state, k, R[j]);
         j++;
         k++;
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
-
-        if (!state.running)
-            return;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
     }
 }
 
-void mergeHelper(SortState &state, int sortingDelay, int left, int right)
+Generator<Operation> mergeHelper(SortState &state, int left, int right)
 {
     if (left >= right)
-        return;
+        co_return;
 
     int mid = left + (right - left) / 2;
 
-    mergeHelper(state, sortingDelay, left, mid);
-    mergeHelper(state, sortingDelay, mid + 1, right);
+    co_yield mergeHelper(state, left, mid);
+
+    co_yield mergeHelper(state, mid + 1, right);
 
-    merge(state, sortingDelay, left, mid, right);
+    co_yield merge(state, left, mid, right);
 }
 
-void mergeSort(SortState &state, int sortingDelay)
+Generator<Operation> mergeSort(SortState &state)
 {
-    mergeHelper(state, sortingDelay, 0, state.numbers.size() - 1);
-
-    state.sortingComplete = true;
+    co_yield mergeHelper(state, 0, state.numbers.size() - 1);
 }
 
-int partition(SortState &state, int sortingDelay, int low, int high)
+Generator<Operation> partition(SortState &state, int low, int high, int &pivotIndex)
 {
-    std::unique_lock<std::mutex> lock(state.mtx);
-    state.numbers.enableAccessCounting();
-
     int pivot = state.numbers[high];
-
-    state.numbers.disableAccessCounting();
-    lock.unlock();
+    co_yield read(high);
 
     int i = (low - 1);
 
     for (int j = low; j <= high - 1; j++) {
-        std::unique_lock<std::mutex> lock(state.mtx);
-        state.numbers.enableAccessCounting();
+        co_yield compare(j, high);
 
         if (state.numbers[j] <= pivot) {
             i++;
-            std::swap(state.numbers[i], state.numbers[j]);
-        }
-
-        state.comparisons++;
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
 
-        if (!state.running)
-            return -1;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
+            if (i != j)
+                co_yield swap(state, i, j);
+        }
     }
 
-    lock.lock();
-    state.numbers.enableAccessCounting();
-
-    std::swap(state.numbers[i + 1], state.numbers[high]);
+    if (i + 1 != high)
+        co_yield swap(state, i + 1, high);
 
-    state.numbers.disableAccessCounting();
-    lock.unlock();
-
-    return (i + 1);
+    pivotIndex = i + 1;
 }
 
-void quickHelper(SortState &state, int sortingDelay, int low, int high)
+Generator<Operation> quickHelper(SortState &state, int low, int high)
 {
     if (low < high) {
-        int pi = partition(state, sortingDelay, low, high);
+        int pi = -1;
+
+        co_yield partition(state, low, high, pi);
 
-        if (pi == -1)
-            return;
+        co_yield quickHelper(state, low, pi - 1);
 
-        quickHelper(state, sortingDelay, low, pi - 1);
-        quickHelper(state, sortingDelay, pi + 1, high);
+        co_yield quickHelper(state, pi + 1, high);
     }
 }
 
-void quickSort(SortState &state, int sortingDelay)
+Generator<Operation> quickSort(SortState &state)
 {
-    quickHelper(state, sortingDelay, 0, state.numbers.size() - 1);
-
-    state.sortingComplete = true;
+    co_yield quickHelper(state, 0, state.numbers.size() - 1);
 }
 
-void shuffle(SortState &state, int sortingDelay)
+Generator<Operation> shuffle(SortState &state)
 {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<> dist(0, state.numbers.size() - 1);
 
     for (int i = state.numbers.size() - 1; i > 0; i--)
-    {
-        std::unique_lock<std::mutex> lock(state.mtx);
-        state.numbers.enableAccessCounting();
-
-        std::swap(state.numbers[i], state.numbers[dist(gen)]);
-
-        state.numbers.disableAccessCounting();
-        lock.unlock();
-
-        if (!state.running)
-            return;
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
-    }
+        co_yield swap(state, i, dist(gen));
 }
 
-void bogoSort(SortState &state, int sortingDelay)
+Generator<Operation> bogoSort(SortState &state)
 {
-    while (!state.sortingComplete)
+    while (true)
     {
-        shuffle(state, sortingDelay);
+        co_yield shuffle(state);
 
-        for (int i = 0; i < state.numbers.size(); i++)
-        {
-            std::unique_lock<std::mutex> lock(state.mtx);
-            state.numbers.enableAccessCounting();
+        int i = 1;
 
-            state.comparisons++;
+        while (i < state.numbers.size())
+        {
+            co_yield compare(i - 1, i);
 
             // Try again
             if (state.numbers[i] < state.numbers[i - 1])
-            {
-                state.numbers.disableAccessCounting();
-                lock.unlock();
                 break;
-            }
 
-            if (i == state.numbers.size() - 1)
-            {
-                state.numbers.disableAccessCounting();
-                lock.unlock();
-                state.sortingComplete = true;
-                break;
-            }
+            i++;
+        }
+
+        if (i >= state.numbers.size())
+            co_return;
+    }
+}
 
-            state.numbers.disableAccessCounting();
-            lock.unlock();
+Generator<Operation> verify(SortState &state)
+{
+    const int begin = state.settledBegin;
+    const int end = state.settledEnd;
+
+    for (int i = 0; i < state.numbers.size(); i++)
+    {
+        bool ordered = true;
 
-            if (!state.running)
-                return;
+        if (i > begin && i < end)
+            ordered = state.numbers[i - 1] <= state.numbers[i];
+        else if (i < begin)
+            ordered = state.numbers[i] <= state.numbers[begin];
+        else if (i >= end && end > begin)
+            ordered = state.numbers[i] >= state.numbers[end - 1];
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(sortingDelay));
+        if (!ordered)
+        {
+            std::cerr << "Sorting failed." << std::endl;
+            exit(1);
         }
+
+        co_yield Operation{Operation::Check, i, -1, 0, 0};
     }
 }
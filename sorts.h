@@ -2,21 +2,36 @@
 #define SORTS_H
 
 #include "SortState.h"
+#include "Operation.h"
+#include "Generator.h"
 
-void bubbleSort(SortState &state, int sortingDelay);
-void selectionSort(SortState &state, int sortingDelay);
-void insertionSort(SortState &state, int sortingDelay);
+// Helpers that apply a mutation and describe it as an operation
+Operation compare(int first, int second);
+Operation read(int index);
+Operation swap(SortState &state, int first, int second);
+Operation write(SortState &state, int index, int value);
+Operation settle(int first, int last);
+Operation layer(int index, int count);
+
+Generator<Operation> bubbleSort(SortState &state);
+Generator<Operation> selectionSort(SortState &state);
+Generator<Operation> insertionSort(SortState &state);
 
 // Merge sort
-void merge(SortState &state, int sortingDelay, int left, int mid, int right);
-void mergeHelper(SortState &state, int sortingDelay, int left, int right);
-void mergeSort(SortState &state, int sortingDelay);
+Generator<Operation> merge(SortState &state, int left, int mid, int right);
+Generator<Operation> mergeHelper(SortState &state, int left, int right);
+Generator<Operation> mergeSort(SortState &state);
 
 // Quick sort
-int partition(SortState &state, int sortingDelay, int low, int high);
-void quickHelper(SortState &state, int sortingDelay, int low, int high);
-void quickSort(SortState &state, int sortingDelay);
+Generator<Operation> partition(SortState &state, int low, int high, int &pivotIndex);
+Generator<Operation> quickHelper(SortState &state, int low, int high);
+Generator<Operation> quickSort(SortState &state);
+
+Generator<Operation> shuffle(SortState &state);
+Generator<Operation> bogoSort(SortState &state);
 
-void bogoSort(SortState &state, int sortingDelay);
+// Sweeps the array checking the settled range is in order and everything
+// before and after it is on the correct side
+Generator<Operation> verify(SortState &state);
 
 #endif // SORTS_H